@@ -0,0 +1,224 @@
+/*
+ * ----- Approximate Minimum Spanning Tree -----
+ * This file provides an approximate MST weight for wirelength estimation.
+ * Points are bucketed into the cells of a quadtree, the occupied cells of a
+ * single level are merged into one representative each, and the spanning
+ * graph is only built on the representatives. The returned weight comes with
+ * a guaranteed error.
+ *
+ *     ************************************************************************
+ *     * Copyright (C) 2015 lionking, National Chiao Tung University, Taiwan. *
+ *     * Permission to use, copy, modify, and distribute this                 *
+ *     * software and its documentation for any purpose and without           *
+ *     * fee is hereby granted, provided that the above copyright             *
+ *     * notice appear in all copies.                                         *
+ *     ************************************************************************
+ *
+ */
+
+#ifndef APPROX_MST_HPP
+#define APPROX_MST_HPP
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include "mst.hpp"
+#include "rsgc.hpp"
+
+
+// interleave the lower 32 bits of x and y into a Morton (Z-order) code,
+// so that code >> 2j identifies the cell of size 2^j containing (x, y)
+inline unsigned long long mortonEncode(unsigned long long x, unsigned long long y)
+{
+	auto spread = [](unsigned long long v) -> unsigned long long {
+		v &= 0x00000000ffffffffULL;
+		v = (v | (v << 16)) & 0x0000ffff0000ffffULL;
+		v = (v | (v << 8)) & 0x00ff00ff00ff00ffULL;
+		v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		v = (v | (v << 2)) & 0x3333333333333333ULL;
+		v = (v | (v << 1)) & 0x5555555555555555ULL;
+		return v;
+	};
+	return spread(x) | (spread(y) << 1);
+}
+
+
+// inverse of the spreading above: collect the even bits of code
+inline unsigned long long mortonCompact(unsigned long long v)
+{
+	v &= 0x5555555555555555ULL;
+	v = (v | (v >> 1)) & 0x3333333333333333ULL;
+	v = (v | (v >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+	v = (v | (v >> 4)) & 0x00ff00ff00ff00ffULL;
+	v = (v | (v >> 8)) & 0x0000ffff0000ffffULL;
+	v = (v | (v >> 16)) & 0x00000000ffffffffULL;
+	return v;
+}
+
+
+// for two different codes with d = code1 ^ code2, return the largest j such
+// that the codes are in different cells of size 2^j
+inline int mortonLevel(unsigned long long d)
+{
+	int level = 0;
+	if (d >> 32) { d >>= 32; level += 16; }
+	if (d >> 16) { d >>= 16; level += 8; }
+	if (d >> 8) { d >>= 8; level += 4; }
+	if (d >> 4) { d >>= 4; level += 2; }
+	if (d >> 2) { level += 1; }
+	return level;
+}
+
+
+/** occupied cell of the quadtree, in units of the cell size **/
+class GridCell
+{
+private:
+	long long x, y;
+
+public:
+	GridCell(const long long a, const long long b) : x(a), y(b) {}
+	inline long long getX() const { return x; }
+	inline long long getY() const { return y; }
+};
+
+
+// MST cost of the occupied cells of size 2^level, measured in cells
+// code must be sorted
+inline long long findGridMST(const std::vector<unsigned long long>& code, const int level)
+{
+	std::vector<GridCell> cell;
+	for (size_t i = 0; i < code.size(); ++i) {
+		const unsigned long long key = code[i] >> (2 * level);
+		if (i > 0 && key == (code[i - 1] >> (2 * level))) { continue; }
+		cell.emplace_back(mortonCompact(key), mortonCompact(key >> 1));
+	}
+	if (cell.size() < 2) { return 0; }
+
+	std::vector< EDGE<long long> > edge_set;
+	buildRSG(cell.begin(), cell.end(), edge_set);
+	bool* mst_edge = new bool[edge_set.size()];
+	const long long weight = findMST(edge_set.begin(), edge_set.end(), mst_edge);
+	delete[] mst_edge;
+	return weight;
+}
+
+
+/******************************** Approximate MST *********************************
+* find the approximate cost of the minimum spanning tree in L1 metric			*
+* Let W be the exact MST cost, n the number of distinct points, and at the		*
+* level with cell size c, k the number of occupied cells and W' c times the MST	*
+* cost of the cells.															*
+* 1. W >= W' - 2(c-1)(k-1) + (n-k), since contracting the cells in the exact	*
+*    MST leaves a spanning tree of the cells with k-1 edges, each edge is		*
+*    shorter than the distance of its cells by at most 2(c-1), and each of the	*
+*    other n-k edges is at least 1.												*
+* 2. W <= W' + 2(c-1)(k-1) + I, where I bounds the wiring inside the cells:		*
+*    each cell of size c connects its occupied quadrants with edges of length	*
+*    at most 2(c-1), so merging k' cells of size c/2 into k cells adds			*
+*    2(c-1)(k'-k) to I.															*
+* 3. W >= half perimeter of the bounding box.									*
+* The gap of these bounds only depends on the number of occupied cells, which	*
+* is counted for every level from one sort of the Morton codes. A lower bound	*
+* of W is taken from a coarse level with at most 4096 cells, and the coarsest	*
+* level whose gap is below 2 * max_error * (lower bound) is used. The exact MST	*
+* is returned when that level does not merge at least half of the points.		*
+* Coordinates are expected to be integers. Nets spanning 2^32 or more are not	*
+* bucketed and the exact MST is returned.										*
+* parameter:																	*
+* 1. first, last: range of points												*
+* 2. max_error: allowed relative error, e.g. 0.03 for 3%						*
+* 3. error: set to the error estimate, |W - return value| <= error				*
+* return value: approximate minimum cost										*
+*********************************************************************************/
+template <typename RandomAccessIterator, typename T>
+T findApproxMST(RandomAccessIterator first, RandomAccessIterator last, const double max_error, T& error)
+{
+	typedef typename std::iterator_traits<RandomAccessIterator>::reference			ref_type;
+	typedef typename std::iterator_traits<RandomAccessIterator>::difference_type	diff_type;
+	const diff_type size = last - first;
+	const int LEVEL = 32;			// number of quadtree levels
+	const long long COARSE = 4096;	// maximum number of cells for the coarse lower bound
+
+	error = T();
+	if (size < 2) { return T(); }
+
+	// bounding box, sizes are computed in unsigned arithmetic to avoid overflow
+	long long xmin = first[0].getX(), xmax = xmin, ymin = first[0].getY(), ymax = ymin;
+	for (int i = 1; i < size; ++i) {
+		ref_type p = first[i];
+		xmin = std::min<long long>(xmin, p.getX()); xmax = std::max<long long>(xmax, p.getX());
+		ymin = std::min<long long>(ymin, p.getY()); ymax = std::max<long long>(ymax, p.getY());
+	}
+	const unsigned long long width = static_cast<unsigned long long>(xmax) - static_cast<unsigned long long>(xmin);
+	const unsigned long long height = static_cast<unsigned long long>(ymax) - static_cast<unsigned long long>(ymin);
+	if (width == 0 && height == 0) { return T(); }
+
+	if (width > 0xffffffffULL || height > 0xffffffffULL) {
+		std::vector< EDGE<long long> > edge_set;
+		buildRSG(first, last, edge_set);
+		bool* mst_edge = new bool[edge_set.size()];
+		const long long weight = findMST(edge_set.begin(), edge_set.end(), mst_edge);
+		delete[] mst_edge;
+		return static_cast<T>(weight);
+	}
+	const long long hpwl = static_cast<long long>(width + height);
+
+	std::vector<unsigned long long> code(size);
+	for (int i = 0; i < size; ++i) {
+		ref_type p = first[i];
+		code[i] = mortonEncode(static_cast<unsigned long long>(p.getX()) - static_cast<unsigned long long>(xmin),
+			static_cast<unsigned long long>(p.getY()) - static_cast<unsigned long long>(ymin));
+	}
+	std::sort(code.begin(), code.end());
+
+	// cell[j]: number of occupied cells of size 2^j, cell[0] is the number of distinct points
+	long long cell[LEVEL + 1];
+	std::fill(cell, cell + LEVEL + 1, 0);
+	for (int i = 1; i < size; ++i) {
+		if (code[i] != code[i - 1]) { ++cell[mortonLevel(code[i] ^ code[i - 1])]; }
+	}
+	cell[LEVEL] = 1;
+	for (int j = LEVEL - 1; j >= 0; --j) { cell[j] += cell[j + 1]; }
+
+	// gap[j]: difference of the upper and lower bounds at level j
+	// inner[j]: bound of the wiring inside the cells at level j
+	double gap[LEVEL], inner[LEVEL];
+	gap[0] = inner[0] = 0.0;
+	for (int j = 1; j < LEVEL; ++j) {
+		const double c = static_cast<double>(1ULL << j);
+		inner[j] = inner[j - 1] + 2.0 * (c - 1.0) * static_cast<double>(cell[j - 1] - cell[j]);
+		gap[j] = 4.0 * (c - 1.0) * static_cast<double>(cell[j] - 1) + inner[j] - static_cast<double>(cell[0] - cell[j]);
+	}
+
+	// lower bound of W at level j from the MST cost of its cells
+	auto lowerBound = [&](const int j, const long long grid_weight) -> long long {
+		const long long c = 1LL << j;
+		return c * grid_weight - 2 * (c - 1) * (cell[j] - 1) + (cell[0] - cell[j]);
+	};
+
+	int coarse = 0;
+	while (cell[coarse] > COARSE) { ++coarse; }
+	if (coarse == 0) { return static_cast<T>(findGridMST(code, 0)); }
+	const long long coarse_weight = findGridMST(code, coarse);
+	const long long lower = std::max(hpwl, lowerBound(coarse, coarse_weight));
+
+	int level = 0;
+	for (int j = LEVEL - 1; j > 0; --j) {
+		if (gap[j] <= 2.0 * max_error * static_cast<double>(lower)) { level = j; break; }
+	}
+	// merging fewer than half of the points does not pay off
+	if (2 * cell[level] > cell[0]) { level = 0; }
+	if (level == 0) { return static_cast<T>(findGridMST(code, 0)); }
+
+	const long long c = 1LL << level;
+	const long long grid_weight = (level == coarse) ? coarse_weight : findGridMST(code, level);
+	const long long upper = c * grid_weight + 2 * (c - 1) * (cell[level] - 1) + static_cast<long long>(inner[level]);
+	const long long lower_level = std::max(lower, lowerBound(level, grid_weight));
+	const long long estimate = lower_level + (upper - lower_level) / 2;
+	error = static_cast<T>(upper - estimate);
+	return static_cast<T>(estimate);
+}
+
+
+#endif
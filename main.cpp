@@ -1,6 +1,11 @@
+#include <cstdio>
+#include <cstdlib>
 #include <vector>
 #include "rsgc.hpp"
 #include "mst.hpp"
+#include "rsmt.hpp"
+#include "approx_mst.hpp"
+#include "mst_cache.hpp"
 
 
 class Coor
@@ -17,38 +22,184 @@ public:
 };
 
 
-bool operator== (const Coor& lhs, const Coor& rhs)
+// check that edge is a spanning tree of point, and each edge is weighted by the
+// distance of its end points
+// return value: total weight, or -1 when edge is not a spanning tree
+int checkSpanningTree(const std::vector<Coor>& point, const std::vector< EDGE<int> >& edge)
 {
-	return ((lhs.getX() == rhs.getX()) && (lhs.getY() == rhs.getY()));
+	const int size = static_cast<int>(point.size());
+	if (static_cast<int>(edge.size()) != size - 1) { return -1; }
+
+	DisjointSet ds(size);
+	int weight = 0;
+	for (auto iter = edge.begin(); iter != edge.end(); ++iter) {
+		if (iter->p1 < 0 || iter->p1 >= size || iter->p2 < 0 || iter->p2 >= size) { return -1; }
+		if (ds.checkRoot(iter->p1) == ds.checkRoot(iter->p2)) { return -1; }
+		const Coor& a = point[iter->p1];
+		const Coor& b = point[iter->p2];
+		if (iter->weight != computeMD(a.getX(), a.getY(), b.getX(), b.getY())) { return -1; }
+		ds.unionSet(iter->p1, iter->p2);
+		weight += iter->weight;
+	}
+	return weight;
+}
+
+
+// run every algorithm on a net and check them against each other
+// return value: true when all of the checks pass
+bool checkNet(const int net, const std::vector<Coor>& coor, MSTCache<int>& mst_cache)
+{
+	const int size = static_cast<int>(coor.size());
+
+	// generate spanning graph
+	std::vector< EDGE<int> > edge_set;
+	buildRSG(coor.begin(), coor.end(), edge_set);
+	// find MST
+	bool* mst_edge = new bool[edge_set.size()];
+	const int mst_weight1 = findMST(edge_set.begin(), edge_set.end(), mst_edge);
+	delete[] mst_edge;
+
+	// the MST of the complete graph is the reference
+	std::vector< EDGE<int> > complete_set;
+	buildCompleteGraph(coor.begin(), coor.end(), complete_set);
+	bool* complete_edge = new bool[complete_set.size()];
+	const int mst_weight0 = findMST(complete_set.begin(), complete_set.end(), complete_edge);
+	delete[] complete_edge;
+
+	// find MST as a tree rooted at the first point, edge_set is left untouched
+	MST_TREE<int> mst_tree;
+	const int mst_weight3 = findMSTTree(edge_set.begin(), edge_set.end(), size, 0, mst_tree);
+
+	// find MST through the cache of repeated pin patterns
+	std::vector< EDGE<int> > cached_edge;
+	const int mst_weight2 = mst_cache.query(coor.begin(), coor.end(), cached_edge);
+
+	// the same pin pattern translated and in another order must hit the cache
+	std::vector<int> order(size);
+	for (int i = 0; i < size; ++i) { order[i] = i; }
+	for (int i = size - 1; i > 0; --i) { std::swap(order[i], order[rand() % (i + 1)]); }
+	std::vector<Coor> moved(size);
+	for (int i = 0; i < size; ++i) { moved[i].set(coor[order[i]].getX() + 12345, coor[order[i]].getY() - 678); }
+	const unsigned long long hits = mst_cache.hits();
+	std::vector< EDGE<int> > moved_edge;
+	const int mst_weight4 = mst_cache.query(moved.begin(), moved.end(), moved_edge);
+
+	// estimate MST weight within 3% error
+	int approx_error;
+	const int approx_weight = findApproxMST(coor.begin(), coor.end(), 0.03, approx_error);
+
+	// find nearest neighbors
+	std::vector<int> octant_nn(8 * size), nearest(size);
+	findAllNN(coor.begin(), coor.end(), octant_nn.data(), nearest.data());
+
+	// find rectilinear steiner tree
+	std::vector< STEINER_POINT<int> > steiner_set;
+	std::vector< EDGE<int> > steiner_edge;
+	const int rsmt_weight = findRSMT(coor.begin(), coor.end(), steiner_set, steiner_edge);
+
+	// every way of finding the MST must agree
+	if (mst_weight1 != mst_weight0) {
+		fprintf(stderr, "net %d: MST weight of the spanning graph %d != %d (complete graph)\n", net, mst_weight1, mst_weight0);
+		return false;
+	}
+	if (mst_weight2 != mst_weight1 || mst_weight3 != mst_weight1 || mst_weight4 != mst_weight1) {
+		fprintf(stderr, "net %d: MST weight mismatch, %d (cache) %d (tree) %d (cache hit) != %d\n", net, mst_weight2, mst_weight3, mst_weight4, mst_weight1);
+		return false;
+	}
+	if (mst_cache.hits() != hits + 1) {
+		fprintf(stderr, "net %d: translated and permuted net missed the cache\n", net);
+		return false;
+	}
+	if (checkSpanningTree(coor, cached_edge) != mst_weight1 || checkSpanningTree(moved, moved_edge) != mst_weight1) {
+		fprintf(stderr, "net %d: MST edges from the cache do not span the net\n", net);
+		return false;
+	}
+	if (abs(mst_weight1 - approx_weight) > approx_error) {
+		fprintf(stderr, "net %d: approximate MST weight %d +- %d misses %d\n", net, approx_weight, approx_error, mst_weight1);
+		return false;
+	}
+
+	// the steiner tree spans the net and the steiner points
+	std::vector<Coor> steiner_tree(coor);
+	for (auto iter = steiner_set.begin(); iter != steiner_set.end(); ++iter) {
+		steiner_tree.emplace_back();
+		steiner_tree.back().set(iter->getX(), iter->getY());
+	}
+	if (checkSpanningTree(steiner_tree, steiner_edge) != rsmt_weight) {
+		fprintf(stderr, "net %d: RSMT edges do not form a tree of weight %d\n", net, rsmt_weight);
+		return false;
+	}
+	if (rsmt_weight > mst_weight1) {
+		fprintf(stderr, "net %d: RSMT weight %d > MST weight %d\n", net, rsmt_weight, mst_weight1);
+		return false;
+	}
+
+	for (int i = 0; i < size; ++i) {
+		int min_md = -1;
+		for (int j = 0; j < size; ++j) {
+			if (j == i) { continue; }
+			const int md = computeMD(coor[i].getX(), coor[i].getY(), coor[j].getX(), coor[j].getY());
+			if (min_md < 0 || md < min_md) { min_md = md; }
+		}
+		const int nn = nearest[i];
+		if (computeMD(coor[i].getX(), coor[i].getY(), coor[nn].getX(), coor[nn].getY()) != min_md) {
+			fprintf(stderr, "net %d: nearest neighbor of point %d is wrong\n", net, i);
+			return false;
+		}
+	}
+	return true;
 }
 
 
 int main()
 {
-#define PC		20
 #define RANGE	1000
 #define REPEAT	1000
+	MSTCache<int> mst_cache;
 	for (int rep = 0; rep < REPEAT; ++rep) {
-		// random generated point
-		Coor coor[PC];
-		for (int i = 0; i < PC; ++i) {
-			coor[i].set(rand() % RANGE, rand() % RANGE);
-
-			// check there is no two point with the same coordinate
-			for (int j = 0; j < i; j++) {
-				// re-generate a new point
-				if (coor[i] == coor[j]) { --i; break; }
+		// random generated points, duplicated coordinates are allowed
+		// 1. 20 points, handled by the complete graph
+		// 2. 100 points, handled by the sweep
+		// 3. 100 points on a 10 x 10 grid, most of them duplicated
+		// 4. 60 points on a row or a column, some of them duplicated
+		const int size = (rep % 4 == 0) ? 20 : ((rep % 4 == 3) ? 60 : 100);
+		std::vector<Coor> coor(size);
+		for (int i = 0; i < size; ++i) {
+			switch (rep % 4) {
+			case 2:		coor[i].set(rand() % 10, rand() % 10);	break;
+			case 3:
+				if (rep % 8 == 3) { coor[i].set(rand() % 100, 7); }
+				else { coor[i].set(-3, rand() % 100); }
+				break;
+			default:	coor[i].set(rand() % RANGE, rand() % RANGE);	break;
 			}
 		}
+		if (!checkNet(rep, coor, mst_cache)) { return 1; }
+	}
+	if (mst_cache.hits() < REPEAT) {
+		fprintf(stderr, "%llu cache hits for %d repeated nets\n", mst_cache.hits(), REPEAT);
+		return 1;
+	}
 
-		// generate spanning graph
-		std::vector< EDGE<int> > edge_set;
-		buildRSG(coor, coor + PC, edge_set);
-		// find MST
-		bool* mst_edge = new bool[edge_set.size()];
-		const int mst_weight1 = findMST(edge_set.begin(), edge_set.end(), mst_edge);
-		delete[] mst_edge;
+	// a large clustered net, where the approximate MST merges points
+	std::vector<Coor> cluster(2000), coor(50000);
+	for (auto iter = cluster.begin(); iter != cluster.end(); ++iter) { iter->set(rand() % 1000000, rand() % 1000000); }
+	for (auto iter = coor.begin(); iter != coor.end(); ++iter) {
+		const Coor& c = cluster[rand() % cluster.size()];
+		iter->set(c.getX() + rand() % 8, c.getY() + rand() % 8);
+	}
+	std::vector< EDGE<int> > edge_set;
+	buildRSG(coor.begin(), coor.end(), edge_set);
+	bool* mst_edge = new bool[edge_set.size()];
+	const int mst_weight = findMST(edge_set.begin(), edge_set.end(), mst_edge);
+	delete[] mst_edge;
+	int approx_error;
+	const int approx_weight = findApproxMST(coor.begin(), coor.end(), 0.03, approx_error);
+	if (approx_error <= 0 || approx_error > 0.03 * mst_weight || abs(mst_weight - approx_weight) > approx_error) {
+		fprintf(stderr, "clustered net: approximate MST weight %d +- %d, exact %d\n", approx_weight, approx_error, mst_weight);
+		return 1;
 	}
+
+	printf("%d nets passed, clustered net %d ~ %d +- %d\n", REPEAT + 1, mst_weight, approx_weight, approx_error);
 	return 0;
 }
-
@@ -139,6 +139,28 @@ struct EDGE
 };
 
 
+/****************** minimum spanning tree as a rooted tree ******************
+* parent: parent[v] is the parent of v, -1 for root (and unreached points)	*
+* weight: weight[v] is the weight of edge (v, parent[v])					*
+* order: points in BFS order from root, parents always come before children	*
+* child_begin, child: children of v are child[child_begin[v]] ~				*
+*					  child[child_begin[v+1] - 1], in BFS order				*
+****************************************************************************/
+template <typename T>
+struct MST_TREE
+{
+	int root;
+	std::vector<int> parent;
+	std::vector<T> weight;
+	std::vector<int> order;
+	std::vector<int> child_begin;
+	std::vector<int> child;
+	typedef T value_type;
+
+	MST_TREE() : root(-1) {}
+};
+
+
 /************************** Minimum Spanning Tree (MST) *************************
 * find the cost of minimun spanning tree										*
 * using Kruskal to solve														*
@@ -159,7 +181,10 @@ auto findMST(Iterator edge_begin, Iterator edge_end, bool* mst_edge) -> typename
 
 	weight_type mst_weight = 0;
 	const typename Iterator::difference_type edge_count = edge_end - edge_begin;
-	DisjointSet ds(edge_count);
+	// the disjoint set is indexed by points, not edges
+	int point_count = 0;
+	for (auto iter = edge_begin; iter != edge_end; ++iter) { point_count = std::max(point_count, std::max(iter->p1, iter->p2) + 1); }
+	DisjointSet ds(point_count);
 
 	std::fill(mst_edge, mst_edge + edge_count, false);
 	std::sort(edge_begin, edge_end, [](const EDGE_T_REF lhs, const EDGE_T_REF rhs)->bool { return lhs.weight < rhs.weight; });
@@ -178,5 +203,83 @@ auto findMST(Iterator edge_begin, Iterator edge_end, bool* mst_edge) -> typename
 }
 
 
-#endif
+/********************* Minimum Spanning Tree (rooted tree) **********************
+* find the minimun spanning tree and return it as a tree rooted at root			*
+* the given edges are not reordered												*
+* parameter:																	*
+* 1. edge_begin, edge_end: range of edges										*
+* 2. point_count: amount of points, endpoints must be less than point_count		*
+* 3. root: root of the tree														*
+* 4. tree: the resulting tree (see MST_TREE)									*
+* return value: minimum cost													*
+*********************************************************************************/
+template <typename Iterator, typename T>
+T findMSTTree(Iterator edge_begin, Iterator edge_end, const int point_count, const int root, MST_TREE<T>& tree)
+{
+	const int edge_count = static_cast<int>(edge_end - edge_begin);
+
+	// sort edge indices instead of edges
+	std::vector<int> index(edge_count);
+	for (int i = 0; i < edge_count; ++i) { index[i] = i; }
+	std::sort(index.begin(), index.end(), [&](const int lhs, const int rhs)->bool { return edge_begin[lhs].weight < edge_begin[rhs].weight; });
 
+	// Kruskal, the picked edges are recorded as adjacency lists in CSR form
+	T mst_weight = T();
+	DisjointSet ds(point_count);
+	std::vector<int> picked;
+	picked.reserve(point_count > 0 ? point_count - 1 : 0);
+	std::vector<int> adj_begin(point_count + 1, 0);
+	for (auto iter = index.begin(); iter != index.end(); ++iter) {
+		const int p1 = edge_begin[*iter].p1, p2 = edge_begin[*iter].p2;
+		if (ds.checkRoot(p1) != ds.checkRoot(p2)) {
+			ds.unionSet(p1, p2);
+			mst_weight += edge_begin[*iter].weight;
+			picked.push_back(*iter);
+			++adj_begin[p1 + 1];
+			++adj_begin[p2 + 1];
+		}
+	}
+	for (int i = 0; i < point_count; ++i) { adj_begin[i + 1] += adj_begin[i]; }
+	std::vector<int> adj(adj_begin[point_count]), adj_edge(adj_begin[point_count]);
+	std::vector<int> fill(adj_begin.begin(), adj_begin.end() - 1);
+	for (auto iter = picked.begin(); iter != picked.end(); ++iter) {
+		const int p1 = edge_begin[*iter].p1, p2 = edge_begin[*iter].p2;
+		adj[fill[p1]] = p2; adj_edge[fill[p1]++] = *iter;
+		adj[fill[p2]] = p1; adj_edge[fill[p2]++] = *iter;
+	}
+
+	// BFS from root
+	tree.root = root;
+	tree.parent.assign(point_count, -1);
+	tree.weight.assign(point_count, T());
+	tree.order.clear();
+	tree.order.reserve(point_count);
+	tree.child_begin.assign(point_count + 1, 0);
+	tree.child.clear();
+	if (root < 0 || root >= point_count) { return mst_weight; }
+
+	tree.order.push_back(root);
+	for (size_t i = 0; i < tree.order.size(); ++i) {
+		const int u = tree.order[i];
+		for (int k = adj_begin[u]; k < adj_begin[u + 1]; ++k) {
+			const int v = adj[k];
+			if (v == tree.parent[u]) { continue; }
+			tree.parent[v] = u;
+			tree.weight[v] = edge_begin[adj_edge[k]].weight;
+			tree.order.push_back(v);
+			++tree.child_begin[u + 1];
+		}
+	}
+	for (int i = 0; i < point_count; ++i) { tree.child_begin[i + 1] += tree.child_begin[i]; }
+	tree.child.resize(tree.child_begin[point_count]);
+	std::copy(tree.child_begin.begin(), tree.child_begin.end() - 1, fill.begin());
+	for (size_t i = 1; i < tree.order.size(); ++i) {
+		const int v = tree.order[i];
+		tree.child[fill[tree.parent[v]]++] = v;
+	}
+
+	return mst_weight;
+}
+
+
+#endif
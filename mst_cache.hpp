@@ -0,0 +1,204 @@
+/*
+ * ----- MST Result Cache -----
+ * Nets in regular structures (e.g. standard-cell arrays and buses) often have
+ * the same pin pattern up to translation and point order. This file provides
+ * a bounded, thread-safe LRU cache of MST results keyed by a translation and
+ * order normalized signature of the points.
+ *
+ *     ************************************************************************
+ *     * Copyright (C) 2015 lionking, National Chiao Tung University, Taiwan. *
+ *     * Permission to use, copy, modify, and distribute this                 *
+ *     * software and its documentation for any purpose and without           *
+ *     * fee is hereby granted, provided that the above copyright             *
+ *     * notice appear in all copies.                                         *
+ *     ************************************************************************
+ *
+ */
+
+#ifndef MST_CACHE_HPP
+#define MST_CACHE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <unordered_map>
+#include <mutex>
+#include "mst.hpp"
+#include "rsgc.hpp"
+
+
+/** hash function of a point signature **/
+template <typename T>
+struct SignatureHash
+{
+	size_t operator() (const std::vector<T>& key) const
+	{
+		std::hash<T> hasher;
+		size_t seed = key.size();
+		for (auto iter = key.begin(); iter != key.end(); ++iter) {
+			seed ^= hasher(*iter) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		}
+		return seed;
+	}
+};
+
+
+/************************** MST Cache ****************************
+ * Template parameter:											*
+ * 1. T: type of coordinate and edge weight						*
+ * The signature of a net is its points translated by the lower	*
+ * left corner of the bounding box and sorted by (x, y). MST		*
+ * edges are stored over the sorted order, and remapped to the		*
+ * caller's indices on each query.								*
+ *****************************************************************/
+template <typename T>
+class MSTCache
+{
+private:
+	typedef std::vector<T>	Signature;
+	typedef std::list<const Signature*>	AgeList;	// front: most recently used
+
+	struct Entry
+	{
+		T weight;
+		std::vector< EDGE<T> > edge;
+		typename AgeList::iterator age;
+	};
+
+	size_t capacity;
+	AgeList age_list;
+	std::unordered_map<Signature, Entry, SignatureHash<T> > table;
+	std::mutex table_lock;
+	unsigned long long hit_count, miss_count;
+
+public:
+	MSTCache(const size_t cap = 1024) : capacity(cap), hit_count(0), miss_count(0) {}
+	MSTCache(const MSTCache& rhs) = delete;
+	MSTCache& operator= (const MSTCache& rhs) = delete;
+
+	// find the MST of the given points, looking up the cache first
+	// parameter:
+	// 1. first, last: range of points
+	// 2. mst_edge: set to the MST edges over the indices of the given points
+	// return value: minimum cost
+	template <typename RandomAccessIterator>
+	T query(RandomAccessIterator first, RandomAccessIterator last, std::vector< EDGE<T> >& mst_edge);
+
+	// remove all of the entries and statistics
+	void clear()
+	{
+		std::lock_guard<std::mutex> guard(table_lock);
+		table.clear();
+		age_list.clear();
+		hit_count = miss_count = 0;
+	}
+
+	size_t size()							{ std::lock_guard<std::mutex> guard(table_lock); return table.size(); }
+	unsigned long long hits()				{ std::lock_guard<std::mutex> guard(table_lock); return hit_count; }
+	unsigned long long misses()				{ std::lock_guard<std::mutex> guard(table_lock); return miss_count; }
+	// ratio of queries answered by the cache
+	double hitRate()
+	{
+		std::lock_guard<std::mutex> guard(table_lock);
+		const unsigned long long total = hit_count + miss_count;
+		return (total == 0) ? 0.0 : static_cast<double>(hit_count) / static_cast<double>(total);
+	}
+};
+
+
+template <typename T>
+template <typename RandomAccessIterator>
+T MSTCache<T>::query(RandomAccessIterator first, RandomAccessIterator last, std::vector< EDGE<T> >& mst_edge)
+{
+	typedef typename std::iterator_traits<RandomAccessIterator>::reference			ref_type;
+	typedef typename std::iterator_traits<RandomAccessIterator>::difference_type	diff_type;
+	const diff_type size = last - first;
+
+	mst_edge.clear();
+	if (size < 2) { return T(); }
+
+	// order[k] is the index of the k-th point in canonical order
+	std::vector<int> order(size);
+	T xmin = first[0].getX(), ymin = first[0].getY();
+	for (int i = 0; i < size; ++i) {
+		order[i] = i;
+		xmin = std::min<T>(xmin, first[i].getX());
+		ymin = std::min<T>(ymin, first[i].getY());
+	}
+	std::sort(order.begin(), order.end(),
+		[&](const int lhs, const int rhs) -> bool {
+			ref_type a = first[lhs];
+			ref_type b = first[rhs];
+			if (a.getX() != b.getX()) { return a.getX() < b.getX(); }
+			else { return a.getY() < b.getY(); }
+		}
+	);
+	Signature key;
+	key.reserve(2 * size);
+	for (auto iter = order.begin(); iter != order.end(); ++iter) {
+		ref_type p = first[*iter];
+		key.push_back(p.getX() - xmin);
+		key.push_back(p.getY() - ymin);
+	}
+
+	// cache hit: remap the stored edges to the caller's indices
+	{
+		std::lock_guard<std::mutex> guard(table_lock);
+		auto found = table.find(key);
+		if (found != table.end()) {
+			++hit_count;
+			Entry& entry = found->second;
+			age_list.splice(age_list.begin(), age_list, entry.age);
+			mst_edge.reserve(entry.edge.size());
+			for (auto iter = entry.edge.begin(); iter != entry.edge.end(); ++iter) {
+				mst_edge.emplace_back(order[iter->p1], order[iter->p2], iter->weight);
+			}
+			return entry.weight;
+		}
+		++miss_count;
+	}
+
+	// cache miss: compute without holding the lock
+	std::vector< EDGE<T> > edge_set;
+	buildRSG(first, last, edge_set);
+	bool* selected = new bool[edge_set.size()];
+	const T weight = findMST(edge_set.begin(), edge_set.end(), selected);
+	for (size_t i = 0; i < edge_set.size(); ++i) {
+		if (selected[i]) { mst_edge.push_back(edge_set[i]); }
+	}
+	delete[] selected;
+
+	// rank[i] is the position of the i-th point in canonical order
+	std::vector<int> rank(size);
+	for (int k = 0; k < size; ++k) { rank[order[k]] = k; }
+	Entry entry;
+	entry.weight = weight;
+	entry.edge.reserve(mst_edge.size());
+	for (auto iter = mst_edge.begin(); iter != mst_edge.end(); ++iter) {
+		entry.edge.emplace_back(rank[iter->p1], rank[iter->p2], iter->weight);
+	}
+
+	if (capacity > 0) {
+		std::lock_guard<std::mutex> guard(table_lock);
+		// another thread may have inserted the same signature meanwhile
+		auto inserted = table.emplace(std::move(key), std::move(entry));
+		if (inserted.second) {
+			age_list.push_front(&(inserted.first->first));
+			inserted.first->second.age = age_list.begin();
+			// evict the least recently used entry
+			if (table.size() > capacity) {
+				auto victim = table.find(*age_list.back());
+				age_list.pop_back();
+				table.erase(victim);
+			}
+		}
+	}
+
+	return weight;
+}
+
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ * ----- C Interface of Rectilinear Spanning Graph and MST -----
+ * Implementation of rsg_capi.h. The coordinate arrays given by the caller
+ * are wrapped by a strided iterator, which is passed to buildRSG directly.
+ *
+ *     ************************************************************************
+ *     * Copyright (C) 2015 lionking, National Chiao Tung University, Taiwan. *
+ *     * Permission to use, copy, modify, and distribute this                 *
+ *     * software and its documentation for any purpose and without           *
+ *     * fee is hereby granted, provided that the above copyright             *
+ *     * notice appear in all copies.                                         *
+ *     ************************************************************************
+ *
+ */
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <iterator>
+#include "rsg_capi.h"
+#include "rsgc.hpp"
+#include "mst.hpp"
+
+
+/** point read from caller-owned coordinate arrays **/
+// coordinates are widened to int64_t, so the distance between two int32_t
+// points never overflows
+template <typename T>
+class StridedPoint
+{
+private:
+	const T* x;
+	const T* y;
+
+public:
+	StridedPoint(const T* a, const T* b) : x(a), y(b) {}
+	inline int64_t getX() const { return *x; }
+	inline int64_t getY() const { return *y; }
+};
+
+
+/** random access view over strided coordinate arrays **/
+template <typename T>
+class StridedIterator
+{
+private:
+	const char* x;
+	const char* y;
+	ptrdiff_t stride;
+
+public:
+	typedef StridedPoint<T>					value_type;
+	typedef StridedPoint<T>					reference;
+	typedef const StridedPoint<T>*			pointer;
+	typedef ptrdiff_t						difference_type;
+	typedef std::random_access_iterator_tag	iterator_category;
+
+	StridedIterator(const T* a, const T* b, const ptrdiff_t s)
+		: x(reinterpret_cast<const char*>(a)), y(reinterpret_cast<const char*>(b)), stride(s) {}
+
+	inline reference operator* () const	{ return value_type(reinterpret_cast<const T*>(x), reinterpret_cast<const T*>(y)); }
+	inline reference operator[] (const difference_type i) const
+	{
+		return value_type(reinterpret_cast<const T*>(x + i*stride), reinterpret_cast<const T*>(y + i*stride));
+	}
+	inline StridedIterator& operator++ ()	{ x += stride; y += stride; return *this; }
+	inline bool operator== (const StridedIterator& rhs) const	{ return x == rhs.x; }
+	inline bool operator!= (const StridedIterator& rhs) const	{ return x != rhs.x; }
+	inline StridedIterator operator+ (const difference_type i) const	{ return StridedIterator(*this) += i; }
+	inline StridedIterator& operator+= (const difference_type i)		{ x += i*stride; y += i*stride; return *this; }
+	inline difference_type operator- (const StridedIterator& rhs) const	{ return (x - rhs.x) / stride; }
+};
+
+
+template <typename T>
+int capiMST(const T* x, const T* y, ptrdiff_t stride, const size_t count,
+	int32_t* edge_p1, int32_t* edge_p2, int64_t* edge_weight, int64_t* total_weight)
+{
+	if (count > 0 && (x == nullptr || y == nullptr)) { return RSG_EINVAL; }
+	if (count > static_cast<size_t>(INT32_MAX)) { return RSG_EINVAL; }
+	if (stride == 0) { stride = sizeof(T); }
+	if (stride < 0) { return RSG_EINVAL; }
+	if (total_weight) { *total_weight = 0; }
+	if (count < 2) { return 0; }
+
+	StridedIterator<T> first(x, y, stride);
+	// keep the sweep keys and the edge weights inside int64_t
+	for (size_t i = 0; i < count; ++i) {
+		const StridedPoint<T> p = first[i];
+		if (p.getX() <= -RSG_COOR_LIMIT || p.getX() >= RSG_COOR_LIMIT) { return RSG_EINVAL; }
+		if (p.getY() <= -RSG_COOR_LIMIT || p.getY() >= RSG_COOR_LIMIT) { return RSG_EINVAL; }
+	}
+
+	try {
+		// weights are non-negative, so they are kept unsigned and the cost summed
+		// inside findMST wraps around instead of overflowing; the cost returned to
+		// the caller is checked below
+		std::vector< EDGE<uint64_t> > edge_set;
+		buildRSG(first, first + count, edge_set);
+
+		std::unique_ptr<bool[]> mst_edge(new bool[edge_set.size()]);
+		findMST(edge_set.begin(), edge_set.end(), mst_edge.get());
+
+		int written = 0;
+		uint64_t total = 0;
+		for (size_t i = 0; i < edge_set.size(); ++i) {
+			if (mst_edge[i] == false) { continue; }
+			if (total > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) - edge_set[i].weight) { return RSG_ERANGE; }
+			if (edge_p1) { edge_p1[written] = edge_set[i].p1; }
+			if (edge_p2) { edge_p2[written] = edge_set[i].p2; }
+			if (edge_weight) { edge_weight[written] = static_cast<int64_t>(edge_set[i].weight); }
+			total += edge_set[i].weight;
+			++written;
+		}
+
+		if (total_weight) { *total_weight = static_cast<int64_t>(total); }
+		return written;
+	}
+	catch (const std::bad_alloc&) { return RSG_ENOMEM; }
+}
+
+
+// explicit instantiations for the exported coordinate types
+template int capiMST<int32_t>(const int32_t*, const int32_t*, ptrdiff_t, const size_t, int32_t*, int32_t*, int64_t*, int64_t*);
+template int capiMST<int64_t>(const int64_t*, const int64_t*, ptrdiff_t, const size_t, int32_t*, int32_t*, int64_t*, int64_t*);
+
+
+extern "C" int rsg_mst_i32(const int32_t* x, const int32_t* y, ptrdiff_t stride, size_t count,
+	int32_t* edge_p1, int32_t* edge_p2, int64_t* edge_weight, int64_t* total_weight)
+{
+	return capiMST<int32_t>(x, y, stride, count, edge_p1, edge_p2, edge_weight, total_weight);
+}
+
+
+extern "C" int rsg_mst_i64(const int64_t* x, const int64_t* y, ptrdiff_t stride, size_t count,
+	int32_t* edge_p1, int32_t* edge_p2, int64_t* edge_weight, int64_t* total_weight)
+{
+	return capiMST<int64_t>(x, y, stride, count, edge_p1, edge_p2, edge_weight, total_weight);
+}
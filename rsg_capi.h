@@ -0,0 +1,70 @@
+/*
+ * ----- C Interface of Rectilinear Spanning Graph and MST -----
+ * This file declares a C ABI for building the minimum spanning tree of a
+ * point set, so that the library can be loaded as librsg.so from other
+ * languages (e.g. Python ctypes or Tcl).
+ *
+ * Coordinates are read directly from caller-owned arrays and results are
+ * written into caller-provided buffers; nothing is copied at the boundary.
+ * No global state is used, hence concurrent calls are thread-safe.
+ *
+ *     ************************************************************************
+ *     * Copyright (C) 2015 lionking, National Chiao Tung University, Taiwan. *
+ *     * Permission to use, copy, modify, and distribute this                 *
+ *     * software and its documentation for any purpose and without           *
+ *     * fee is hereby granted, provided that the above copyright             *
+ *     * notice appear in all copies.                                         *
+ *     ************************************************************************
+ *
+ */
+
+#ifndef RSG_CAPI_H
+#define RSG_CAPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* return codes */
+#define RSG_OK			0
+#define RSG_EINVAL		-1	/* invalid argument */
+#define RSG_ENOMEM		-2	/* out of memory */
+#define RSG_ERANGE		-3	/* cost of the MST does not fit in int64_t */
+
+/* coordinates must be strictly between -RSG_COOR_LIMIT and RSG_COOR_LIMIT */
+#define RSG_COOR_LIMIT	(INT64_C(1) << 61)
+
+/*********************** Minimum Spanning Tree (MST) ***********************
+ * parameter:																*
+ * 1. x, y: coordinates of the first point. The i-th point is located at	*
+ *          (char*)x + i*stride and (char*)y + i*stride						*
+ *          Coordinates must be inside (-RSG_COOR_LIMIT, RSG_COOR_LIMIT),	*
+ *          otherwise RSG_EINVAL is returned								*
+ * 2. stride: distance in bytes between two consecutive points, 0 means		*
+ *            densely packed arrays (i.e. sizeof(coordinate))				*
+ *            e.g. interleaved {x0, y0, x1, y1, ...}: y = x + 1,			*
+ *            stride = 2 * sizeof(coordinate)								*
+ * 3. count: number of points. Duplicate points are allowed and are			*
+ *           connected by zero weight edges									*
+ * 4. edge_p1, edge_p2, edge_weight: MST edges, each buffer must hold		*
+ *    count - 1 entries. Any of them can be NULL if not needed				*
+ *    Weights are int64_t for both coordinate types, since the distance		*
+ *    between two int32_t points can exceed INT32_MAX						*
+ * 5. total_weight: set to the cost of the MST, can be NULL					*
+ * return value: number of MST edges written, or a negative error code		*
+ *               (the edge buffers may be partially written on error)		*
+ ***************************************************************************/
+int rsg_mst_i32(const int32_t* x, const int32_t* y, ptrdiff_t stride, size_t count,
+	int32_t* edge_p1, int32_t* edge_p2, int64_t* edge_weight, int64_t* total_weight);
+
+int rsg_mst_i64(const int64_t* x, const int64_t* y, ptrdiff_t stride, size_t count,
+	int32_t* edge_p1, int32_t* edge_p2, int64_t* edge_weight, int64_t* total_weight);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
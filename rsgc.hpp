@@ -21,24 +21,76 @@
 #define RSGC_HPP
 
 #include <cstdlib>
-#include <cfloat>
+#include <cmath>
 #include <vector>
 #include <algorithm>
 #include <iterator>
+#include <utility>
+#include <type_traits>
+#include <functional>
+#include <unordered_map>
+#include <set>
 #include "mst.hpp"
-#include "bst.hpp"
 
 
 /* Example of MST */
 template <typename T>
 inline T computeMD(const T x1, const T y1, const T x2, const T y2)
 {
-	return abs(x1 - x2) + abs(y1 - y2);
+	return std::abs(x1 - x2) + std::abs(y1 - y2);
 }
 
 
+/** coordinate type used by the sweep: integers are widened to long long **/
+// so that x + y and x - y of the transformed coordinates do not overflow
+template <typename T>
+struct WideCoor
+{
+	typedef typename std::conditional<std::is_integral<T>::value, long long, T>::type type;
+};
+
+
+/***************************** metric policies ******************************
+* The spanning graph is built in the coordinates given by getX() / getY()	*
+* of a metric. distance() must be a positive multiple of the L1 distance	*
+* in those coordinates, so that the sweep keeps its O(n log n) bound.		*
+* Transformed coordinates are computed in WideCoor<T>::type, hence they		*
+* are exact for 32-bit coordinates, and for 64-bit coordinates whose		*
+* absolute values are less than 2^61.										*
+****************************************************************************/
+
+/** Manhattan (L1) metric: |dx| + |dy| **/
+struct ManhattanMetric
+{
+	template <typename T> static inline typename WideCoor<T>::type getX(const T x, const T)	{ return x; }
+	template <typename T> static inline typename WideCoor<T>::type getY(const T, const T y)	{ return y; }
+	template <typename T> static inline T distance(const T x1, const T y1, const T x2, const T y2)	{ return computeMD(x1, y1, x2, y2); }
+};
+
+/** Chebyshev (L-infinity) metric: max(|dx|, |dy|) **/
+// after rotating by 45 degrees with (x + y, y - x), the L1 distance is exactly
+// 2 * max(|dx|, |dy|); the weight itself is computed on the original coordinates.
+// L1 on axes rotated by 45 degrees is sqrt(2) * max(|dx|, |dy|), so this metric
+// also gives its minimum spanning tree.
+struct ChebyshevMetric
+{
+	template <typename T> static inline typename WideCoor<T>::type getX(const T x, const T y)
+	{
+		return static_cast<typename WideCoor<T>::type>(x) + y;
+	}
+	template <typename T> static inline typename WideCoor<T>::type getY(const T x, const T y)
+	{
+		return static_cast<typename WideCoor<T>::type>(y) - x;
+	}
+	template <typename T> static inline T distance(const T x1, const T y1, const T x2, const T y2)
+	{
+		return std::max(std::abs(x1 - x2), std::abs(y1 - y2));
+	}
+};
+
+
 /** build complete graph **/
-template <typename Iterator, typename T>
+template <typename Metric = ManhattanMetric, typename Iterator, typename T>
 inline void buildCompleteGraph(Iterator first, Iterator last, std::vector< EDGE<T> >& edge_set)
 {
 	typedef typename std::iterator_traits<Iterator>::difference_type	diff_type;
@@ -53,14 +105,14 @@ inline void buildCompleteGraph(Iterator first, Iterator last, std::vector< EDGE<
 		for (++end, j=i+1; end != last; ++end, ++j) {
 			ref_type p1 = *beg;
 			ref_type p2 = *end;
-			const int w = computeMD(p1.getX(), p1.getY(), p2.getX(), p2.getY());
+			const T w = Metric::distance(p1.getX(), p1.getY(), p2.getX(), p2.getY());
 			edge_set.emplace_back(i, j, w);
 		}
 	}
 }
 
 
-template <typename T>
+template <typename T, typename Metric = ManhattanMetric>
 class XLess
 {
 private:
@@ -70,18 +122,21 @@ public:
 	XLess(T& f) : first(f) {}
 	XLess(const XLess& rhs) : first(rhs.first) {}
 
-	bool operator() (const int lhs, const int rhs)
+	bool operator() (const int lhs, const int rhs) const
 	{
 		typedef typename std::iterator_traits<T>::reference		ref_type;
 		ref_type a = first[lhs];
 		ref_type b = first[rhs];
-		if (a.getX() != b.getX()) { return a.getX() < b.getX(); }
-		else { return a.getY() < b.getY(); }
+		const auto ax = Metric::getX(a.getX(), a.getY()), bx = Metric::getX(b.getX(), b.getY());
+		if (ax != bx) { return ax < bx; }
+		else { return Metric::getY(a.getX(), a.getY()) < Metric::getY(b.getX(), b.getY()); }
 	}
 };
 
 
-template <typename T>
+// note: points with the same y are sorted in descending order of x, so the
+// R2 sweep visits them in ascending order of (x - y)
+template <typename T, typename Metric = ManhattanMetric>
 class YLess
 {
 private:
@@ -91,18 +146,19 @@ public:
 	YLess(T& f) : first(f) {}
 	YLess(const YLess& rhs) : first(rhs.first) {}
 
-	bool operator() (const int lhs, const int rhs)
+	bool operator() (const int lhs, const int rhs) const
 	{
 		typedef typename std::iterator_traits<T>::reference		ref_type;
 		ref_type a = first[lhs];
 		ref_type b = first[rhs];
-		if (a.getY() != b.getY()) { return a.getY() < b.getY(); }
-		else { return a.getX() < b.getX(); }
+		const auto ay = Metric::getY(a.getX(), a.getY()), by = Metric::getY(b.getX(), b.getY());
+		if (ay != by) { return ay < by; }
+		else { return Metric::getX(a.getX(), a.getY()) > Metric::getX(b.getX(), b.getY()); }
 	}
 };
 
 
-template <typename T>
+template <typename T, typename Metric = ManhattanMetric>
 class YLarge
 {
 private:
@@ -112,169 +168,414 @@ public:
 	YLarge(T& f) : first(f) {}
 	YLarge(const YLarge& rhs) : first(rhs.first) {}
 
-	bool operator() (const int lhs, const int rhs)
+	bool operator() (const int lhs, const int rhs) const
 	{
 		typedef typename std::iterator_traits<T>::reference		ref_type;
 		ref_type a = first[lhs];
 		ref_type b = first[rhs];
-		if (a.getY() != b.getY()) { return a.getY() > b.getY(); }
-		else { return a.getX() < b.getX(); }
+		const auto ay = Metric::getY(a.getX(), a.getY()), by = Metric::getY(b.getX(), b.getY());
+		if (ay != by) { return ay > by; }
+		else { return Metric::getX(a.getX(), a.getY()) < Metric::getX(b.getX(), b.getY()); }
+	}
+};
+
+
+/** view of points reflected about the origin: (x, y) -> (-x, -y) **/
+template <typename Iterator>
+class ReflectIterator
+{
+private:
+	typedef typename std::iterator_traits<Iterator>::reference	base_ref;
+	typedef typename std::decay<decltype(std::declval<base_ref>().getX())>::type	coor_type;
+
+	Iterator base;
+
+public:
+	class value_type
+	{
+	private:
+		coor_type x, y;
+
+	public:
+		value_type(coor_type a, coor_type b) : x(a), y(b) {}
+		inline coor_type getX() const { return x; }
+		inline coor_type getY() const { return y; }
+	};
+	typedef value_type												reference;
+	typedef const value_type*										pointer;
+	typedef typename std::iterator_traits<Iterator>::difference_type	difference_type;
+	typedef std::random_access_iterator_tag							iterator_category;
+
+	ReflectIterator(Iterator iter) : base(iter) {}
+
+	inline reference operator[] (const difference_type i) const
+	{
+		base_ref p = base[i];
+		return value_type(-p.getX(), -p.getY());
 	}
+	inline difference_type operator- (const ReflectIterator& rhs) const	{ return base - rhs.base; }
 };
 
 
+/** view of the points selected by an index array: i -> base[index[i]] **/
+template <typename Iterator>
+class IndexIterator
+{
+private:
+	Iterator base;
+	const int* index;
+
+public:
+	typedef typename std::iterator_traits<Iterator>::value_type		value_type;
+	typedef typename std::iterator_traits<Iterator>::reference		reference;
+	typedef typename std::iterator_traits<Iterator>::pointer		pointer;
+	typedef typename std::iterator_traits<Iterator>::difference_type	difference_type;
+	typedef std::random_access_iterator_tag							iterator_category;
+
+	IndexIterator(Iterator iter, const int* idx) : base(iter), index(idx) {}
+
+	inline reference operator* () const								{ return base[*index]; }
+	inline reference operator[] (const difference_type i) const		{ return base[index[i]]; }
+	inline IndexIterator& operator++ ()								{ ++index; return *this; }
+	inline IndexIterator operator+ (const difference_type i) const	{ return IndexIterator(base, index + i); }
+	inline difference_type operator- (const IndexIterator& rhs) const	{ return index - rhs.index; }
+	inline bool operator== (const IndexIterator& rhs) const			{ return index == rhs.index; }
+	inline bool operator!= (const IndexIterator& rhs) const			{ return index != rhs.index; }
+};
+
+
+/** hash function of a coordinate pair **/
+template <typename T>
+struct CoorHash
+{
+	size_t operator() (const std::pair<T, T>& p) const
+	{
+		std::hash<T> hasher;
+		size_t seed = hasher(p.first);
+		return seed ^ (hasher(p.second) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+	}
+};
+
+
+/***************************** collapse duplicated points ***************************
+ * parameter:																		*
+ * 1. first, last: range of points													*
+ * 2. unique: set to the indices of distinct points (the first one of each group)	*
+ * 3. rep: rep[i] is set to the index of the first point located at the same		*
+ *		   coordinate as the i-th point												*
+ * return value: true when there is any duplicated point							*
+ ************************************************************************************/
+template <typename RandomAccessIterator>
+bool collapseDuplicates(RandomAccessIterator first, RandomAccessIterator last, std::vector<int>& unique, std::vector<int>& rep)
+{
+	typedef typename std::iterator_traits<RandomAccessIterator>::reference			ref_type;
+	typedef typename std::iterator_traits<RandomAccessIterator>::difference_type	diff_type;
+	typedef typename std::decay<decltype(std::declval<ref_type>().getX())>::type	coor_type;
+	const diff_type size = last - first;
+
+	std::unordered_map<std::pair<coor_type, coor_type>, int, CoorHash<coor_type> > table;
+	table.reserve(size);
+	unique.clear();
+	unique.reserve(size);
+	rep.resize(size);
+	for (int i = 0; i < size; ++i) {
+		ref_type p = first[i];
+		auto inserted = table.emplace(std::make_pair(p.getX(), p.getY()), i);
+		rep[i] = inserted.first->second;
+		if (inserted.second) { unique.push_back(i); }
+	}
+	return static_cast<diff_type>(unique.size()) != size;
+}
+
+
+/******************************* collinear points **********************************
+ * when the selected points are on the same row or column, their minimum spanning	*
+ * tree is the chain sorted along that line (under any metric given by a norm)		*
+ * parameter:																		*
+ * 1. first: begin of points														*
+ * 2. index: indices of the selected distinct points, sorted along the line when	*
+ *			 they are collinear														*
+ * return value: true when the selected points are collinear						*
+ ************************************************************************************/
+template <typename RandomAccessIterator>
+bool sortCollinear(RandomAccessIterator first, std::vector<int>& index)
+{
+	typedef typename std::iterator_traits<RandomAccessIterator>::reference			ref_type;
+
+	if (index.empty()) { return true; }
+	ref_type a = first[index.front()];
+	bool row = true, column = true;
+	for (auto iter = index.begin(); iter != index.end() && (row || column); ++iter) {
+		ref_type b = first[*iter];
+		row = row && (b.getY() == a.getY());
+		column = column && (b.getX() == a.getX());
+	}
+	if (row) {
+		std::sort(index.begin(), index.end(), [&](const int lhs, const int rhs) -> bool { return first[lhs].getX() < first[rhs].getX(); });
+	}
+	else if (column) {
+		std::sort(index.begin(), index.end(), [&](const int lhs, const int rhs) -> bool { return first[lhs].getY() < first[rhs].getY(); });
+	}
+	return row || column;
+}
+
+
+/************************** octant nearest neighbor sweep ***************************
+ * For point p and point q, let dx = q.x - p.x and dy = q.y - p.y.					*
+ * q is inside the octants of p when												*
+ * R1: dx >= 0, dy > dx				R2: dx > 0, 0 < dy <= dx						*
+ * R3: dx > 0, -dx < dy <= 0		R4: dx > 0, dy <= -dx							*
+ * and R5 ~ R8 are R1 ~ R4 reflected about p.										*
+ * x and y are the coordinates given by Metric (see metric policies).				*
+ * This function finds the nearest point of each point in R1 ~ R4 by sweeping.		*
+ * Points must be distinct.															*
+ * The active sets are balanced search trees, so the sweep takes O(n log n)			*
+ * time even for nearly collinear points.											*
+ * parameter:																		*
+ * 1. first, last: range of points													*
+ * 2. nn: nn[4*i + k] is set to the nearest point of the i-th point in R(k+1),		*
+ *		  or -1 when that octant is empty											*
+ ************************************************************************************/
+template <typename Metric = ManhattanMetric, typename RandomAccessIterator>
+void sweepOctantNN(RandomAccessIterator first, RandomAccessIterator last, int* nn)
+{
+	typedef typename std::iterator_traits<RandomAccessIterator>::reference			ref_type;
+	typedef typename std::iterator_traits<RandomAccessIterator>::difference_type	diff_type;
+	const diff_type size = last - first;
+
+	// coordinates measured by the metric
+	auto mx = [](ref_type p) { return Metric::getX(p.getX(), p.getY()); };
+	auto my = [](ref_type p) { return Metric::getY(p.getX(), p.getY()); };
+
+	std::fill(nn, nn + 4 * size, -1);
+	int* index = new int[size];
+	for (int i = 0; i < size; ++i) { index[i] = i; }
+
+	XLess<RandomAccessIterator, Metric> xless = XLess<RandomAccessIterator, Metric>(first);
+	YLess<RandomAccessIterator, Metric> yless = YLess<RandomAccessIterator, Metric>(first);
+	std::set< int, XLess<RandomAccessIterator, Metric> > as1(xless);	// R1 active set
+	std::set< int, YLess<RandomAccessIterator, Metric> > as2(yless);	// R2 active set
+
+	// poins are sorted with respect to x + y
+	// hence the first point found inside the R1 (R2) region of b is the nearest one
+	std::sort(index, index + size,
+		[&](const int lhs, const int rhs) -> bool {
+			ref_type a = first[lhs];
+			ref_type b = first[rhs];
+			return (mx(a) + my(a)) < (mx(b) + my(b));
+		}
+	);
+	for (int i = 0; i < size; ++i) {
+		ref_type a = first[index[i]];
+		// no active point is inside the R1 region of another one, so the active points
+		// on the left of a are in ascending order of (y - x) from right to left
+		auto pos1 = as1.lower_bound(index[i]);
+		while (pos1 != as1.begin()) {
+			const auto pt = std::prev(pos1);
+			const int b_index = *pt;
+			ref_type b = first[b_index];
+			if ((my(b) - mx(b)) >= (my(a) - mx(a))) { break; }
+
+			// a is inside the R1 region of b
+			nn[4 * b_index] = index[i];
+			as1.erase(pt);
+		}
+		as1.insert(pos1, index[i]);
+
+		// likewise, the active points below a are in ascending order of (x - y) from top to bottom
+		auto pos2 = as2.lower_bound(index[i]);
+		while (pos2 != as2.begin()) {
+			const auto pt = std::prev(pos2);
+			const int b_index = *pt;
+			ref_type b = first[b_index];
+			if ((mx(b) - my(b)) > (mx(a) - my(a))) { break; }
+
+			// a is inside the R2 region of b
+			nn[4 * b_index + 1] = index[i];
+			as2.erase(pt);
+		}
+		as2.insert(pos2, index[i]);
+	}
+	as1.clear(); as2.clear();
+
+	YLarge<RandomAccessIterator, Metric> ylarge = YLarge<RandomAccessIterator, Metric>(first);
+	std::set< int, YLarge<RandomAccessIterator, Metric> > as3(ylarge);	// R3 active set
+	std::set< int, XLess<RandomAccessIterator, Metric> > as4(xless);	// R4 active set
+
+	// poins are sorted with respect to x - y
+	std::sort(index, index + size,
+		[&](const int lhs, const int rhs) -> bool {
+			ref_type a = first[lhs];
+			ref_type b = first[rhs];
+			return (mx(a) - my(a)) < (mx(b) - my(b));
+		}
+	);
+	for (int i = 0; i < size; ++i) {
+		ref_type a = first[index[i]];
+		// the active points above a are in ascending order of (x + y) from bottom to top
+		auto pos3 = as3.lower_bound(index[i]);
+		while (pos3 != as3.begin()) {
+			const auto pt = std::prev(pos3);
+			const int b_index = *pt;
+			ref_type b = first[b_index];
+			if ((mx(b) + my(b)) >= (mx(a) + my(a))) { break; }
+
+			// a is inside the R3 region of b
+			nn[4 * b_index + 2] = index[i];
+			as3.erase(pt);
+		}
+		as3.insert(pos3, index[i]);
+
+		// the active points on the left of a are in descending order of (x + y) from right to left
+		auto pos4 = as4.lower_bound(index[i]);
+		while (pos4 != as4.begin()) {
+			const auto pt = std::prev(pos4);
+			const int b_index = *pt;
+			ref_type b = first[b_index];
+			if ((mx(b) + my(b)) < (mx(a) + my(a))) { break; }
+
+			// a is inside the R4 region of b
+			nn[4 * b_index + 3] = index[i];
+			as4.erase(pt);
+		}
+		as4.insert(pos4, index[i]);
+	}
+
+	delete[] index;
+}
+
+
 /********************** build rectilinear spanning graph(RSG) ***********************
  * Reference:																		*
  * Hai Zhou, Narendra Shenoy and William Nicholls,									*
  * "Efficient Minimum Spanning Tree Construction without Delaunay Triangulation",	*
  * ASP-DAC, 2001																	*
+ * Template parameter:																*
+ * 1. Metric: distance used as edge weight, e.g. buildRSG<ChebyshevMetric>(...)		*
  ************************************************************************************/
-template <typename RandomAccessIterator, typename T>
+template <typename Metric = ManhattanMetric, typename RandomAccessIterator, typename T>
 void buildRSG(RandomAccessIterator first, RandomAccessIterator last, std::vector< EDGE<T> >& edge_set)
 {
-	typedef typename std::iterator_traits<RandomAccessIterator>::value_type			val_type;
 	typedef typename std::iterator_traits<RandomAccessIterator>::reference			ref_type;
 	typedef typename std::iterator_traits<RandomAccessIterator>::difference_type	diff_type;
 	const diff_type size = last - first;
 
 	// too few points, construct complete graph directly
 	if (size <= 25) {
-		buildCompleteGraph(first, last, edge_set);
+		buildCompleteGraph<Metric>(first, last, edge_set);
 	}
 	// build rectilinear spanning graph according to following paper:
-	// 
+	// each point is connected to its nearest point in R1 ~ R4
 	else {
-		int* index = new int[size];
-		for (int i = 0; i < size; ++i) { index[i] = i; }
-
-		XLess<RandomAccessIterator> xless = XLess<RandomAccessIterator>(first);
-		YLess<RandomAccessIterator> yless = YLess<RandomAccessIterator>(first);
-		BST< int, XLess<RandomAccessIterator> > as1(xless);	// R1 active set
-		BST< int, YLess<RandomAccessIterator> > as2(yless);	// R2 active set
-
-		// poins are sorted with respect to x + y
-		std::sort(index, index+size, 
-			[&](const int lhs, const int rhs) -> bool { 
-				ref_type a = first[lhs];
-				ref_type b = first[rhs];
-				return (a.getX() + a.getY()) < (b.getX() + b.getY());
-			}
-		);
-		for (int i = 0; i < size; ++i) {
-			ref_type a = first[ index[i] ];
-			// find nearest point which has a in its R1 region
-			T min_md = T();
-			int min_index = -1;
-			for (int* pt = as1.queryMaxL(index[i]); pt != nullptr; pt = as1.queryMaxL(*pt)) {
-				ref_type b = first[*pt];
-				if ((b.getX() - b.getY()) <= (a.getX() - a.getY())) { break; }
-
-				// check if a is inside the R1 region of b
-				double slope = DBL_MAX;
-				if (a.getX() != b.getX()) { slope = static_cast<double>(b.getY() - a.getY()) / static_cast<double>(b.getX() - a.getX()); }
-				if (slope > 1) {
-					const T wl = computeMD(a.getX(), a.getY(), b.getX(), b.getY());
-					if (min_index < 0 || wl < min_md) { min_index = *pt; min_md = wl; }
-				}
+		// duplicated points are chained by zero-weight edges, each one to the previous
+		// point at the same coordinate, so that no point gets a large degree;
+		// only the distinct points go through the sweep
+		std::vector<int> unique, rep;
+		const bool duplicated = collapseDuplicates(first, last, unique, rep);
+		if (duplicated) {
+			std::vector<int> tail(rep);	// tail[r]: last point seen at the coordinate of r
+			for (int i = 0; i < size; ++i) {
+				if (rep[i] == i) { continue; }
+				edge_set.emplace_back(tail[rep[i]], i, T());
+				tail[rep[i]] = i;
 			}
-			// add new edge
-			if (min_index >= 0) {
-				edge_set.emplace_back(index[i], min_index, min_md);
-				// remove from active set
-				as1.erase(min_index);
-			}
-			// push into active set
-			as1.insert(index[i]);
-
-			// find nearest point which has a in its R2 region
-			min_index = -1; min_md = T();
-			for (int* pt = as2.queryMaxL(index[i]); pt != nullptr; pt = as2.queryMaxL(*pt)) {
-				ref_type b = first[*pt];
-				if ((b.getX() - b.getY()) > (a.getX() - a.getY())) { break; }
-
-				// check if a is inside the R2 region of b
-				double slope = DBL_MAX;
-				if (a.getX() != b.getX()) { slope = static_cast<double>(b.getY() - a.getY()) / static_cast<double>(b.getX() - a.getX()); }
-				if ((slope > 0) && (slope <= 1)) {
-					const T wl = computeMD(a.getX(), a.getY(), b.getX(), b.getY());
-					if (min_index < 0 || wl < min_md) { min_index = *pt; min_md = wl; }
-				}
-			}
-			// add new edge
-			if (min_index >= 0) {
-				edge_set.emplace_back(index[i], min_index, min_md);
-				// remove from active set
-				as2.erase(min_index);
-			}
-			// push into active set
-			as2.insert(index[i]);
 		}
-		as1.clear(); as2.clear();
-
-		YLarge<RandomAccessIterator> ylarge = YLarge<RandomAccessIterator>(first);
-		BST< int, YLarge<RandomAccessIterator> > as3(ylarge);	// R3 active set
-		BST< int, XLess<RandomAccessIterator> > as4(xless);	// R4 active set
-
-		// poins are sorted with respect to x - y
-		std::sort(index, index + size,
-			[&](const int lhs, const int rhs) -> bool {
-				ref_type a = first[lhs];
-				ref_type b = first[rhs];
-				return (a.getX() - a.getY()) < (b.getX() - b.getY());
-			}
-		);
-		for (int i = 0; i < size; ++i) {
-			ref_type a = first[index[i]];
-
-			// find nearest point which has a in its R3 region
-			T min_md = T();
-			int min_index = -1;
-			for (int* pt = as3.queryMaxL(index[i]); pt != nullptr; pt = as3.queryMaxL(*pt)) {
-				ref_type b = first[*pt];
-				if ((b.getX() + b.getY()) >= (a.getX() + a.getY())) { break; }
-
-				// check if a is inside the R3 region of b
-				double slope = DBL_MIN;
-				if (a.getX() != b.getX()) { slope = static_cast<double>(b.getY() - a.getY()) / static_cast<double>(b.getX() - a.getX()); }
-				if ((slope <= 0) && (slope > -1)) {
-					const T wl = computeMD(a.getX(), a.getY(), b.getX(), b.getY());
-					if (min_index < 0 || wl < min_md) { min_index = *pt; min_md = wl; }
-				}
-			}
-			// add new edge
-			if (min_index >= 0) {
-				edge_set.emplace_back(index[i], min_index, min_md);
-				// remove from active set
-				as3.erase(min_index);
-			}
-			// push into active set
-			as3.insert(index[i]);
-
-			// find nearest point which has a in its R4 region
-			min_index = -1; min_md = T();
-			for (int* pt = as4.queryMaxL(index[i]); pt != nullptr; pt = as4.queryMaxL(*pt)) {
-				ref_type b = first[*pt];
-				if ((b.getX() + b.getY()) < (a.getX() + a.getY())) { break; }
-
-				// check if a is inside the R4 region of b
-				double slope = DBL_MIN;
-				if (a.getX() != b.getX()) { slope = static_cast<double>(b.getY() - a.getY()) / static_cast<double>(b.getX() - a.getX()); }
-				if (slope <= -1) {
-					const T wl = computeMD(a.getX(), a.getY(), b.getX(), b.getY());
-					if (min_index < 0 || wl < min_md) { min_index = *pt; min_md = wl; }
-				}
+
+		// all points on a row or a column, the chain is the minimum spanning tree
+		if (sortCollinear(first, unique)) {
+			for (size_t i = 1; i < unique.size(); ++i) {
+				ref_type a = first[unique[i - 1]];
+				ref_type b = first[unique[i]];
+				edge_set.emplace_back(unique[i - 1], unique[i], Metric::distance(a.getX(), a.getY(), b.getX(), b.getY()));
 			}
-			// add new edge
-			if (min_index >= 0) {
-				edge_set.emplace_back(index[i], min_index, min_md);
-				// remove from active set
-				as4.erase(min_index);
+			return;
+		}
+
+		// the sweep runs on the given points directly when they are distinct
+		const int count = static_cast<int>(unique.size());
+		int* nn = new int[4 * count];
+		if (duplicated) {
+			IndexIterator<RandomAccessIterator> ufirst(first, unique.data());
+			sweepOctantNN<Metric>(ufirst, ufirst + count, nn);
+		}
+		else { sweepOctantNN<Metric>(first, last, nn); }
+
+		edge_set.reserve(edge_set.size() + 4 * count);
+		for (int i = 0; i < count; ++i) {
+			ref_type a = first[unique[i]];
+			for (int k = 0; k < 4; ++k) {
+				if (nn[4 * i + k] < 0) { continue; }
+				ref_type b = first[unique[nn[4 * i + k]]];
+				edge_set.emplace_back(unique[i], unique[nn[4 * i + k]], Metric::distance(a.getX(), a.getY(), b.getX(), b.getY()));
 			}
-			// push into active set
-			as4.insert(index[i]);
 		}
 
-		delete[] index;
+		delete[] nn;
+	}
+}
+
+
+/****************************** all nearest neighbors *******************************
+ * find the nearest point of every point in each octant (see sweepOctantNN) and		*
+ * its nearest point under Metric, with time complexity O(n log n)					*
+ * Duplicated points share the octant neighbors of the first one of their group,	*
+ * and are the nearest points of each other.										*
+ * parameter:																		*
+ * 1. first, last: range of points													*
+ * 2. octant_nn: octant_nn[8*i + k] is set to the nearest point of the i-th point	*
+ *				 in R(k+1), or -1 when that octant is empty (8n entries)			*
+ * 3. nearest: nearest[i] is set to the nearest point of the i-th point,			*
+ *			   or -1 when there is only one point (n entries)						*
+ ************************************************************************************/
+template <typename Metric = ManhattanMetric, typename RandomAccessIterator>
+void findAllNN(RandomAccessIterator first, RandomAccessIterator last, int* octant_nn, int* nearest)
+{
+	typedef typename std::iterator_traits<RandomAccessIterator>::reference			ref_type;
+	typedef typename std::iterator_traits<RandomAccessIterator>::difference_type	diff_type;
+	const diff_type size = last - first;
+
+	std::vector<int> unique, rep;
+	const bool duplicated = collapseDuplicates(first, last, unique, rep);
+	const int count = static_cast<int>(unique.size());
+	IndexIterator<RandomAccessIterator> ufirst(first, unique.data());
+
+	// R1 ~ R4 of the reflected points are R5 ~ R8 of the original ones
+	int* nn = new int[8 * count];
+	sweepOctantNN<Metric>(ufirst, ufirst + count, nn);
+	sweepOctantNN<Metric>(ReflectIterator< IndexIterator<RandomAccessIterator> >(ufirst),
+		ReflectIterator< IndexIterator<RandomAccessIterator> >(ufirst + count), nn + 4 * count);
+	for (int i = 0; i < count; ++i) {
+		for (int k = 0; k < 8; ++k) {
+			const int j = (k < 4) ? nn[4 * i + k] : nn[4 * count + 4 * i + k - 4];
+			octant_nn[8 * unique[i] + k] = (j < 0) ? -1 : unique[j];
+		}
+	}
+	delete[] nn;
+
+	// octants are disjoint and cover the whole plane
+	for (int i = 0; i < size; ++i) {
+		ref_type a = first[i];
+		nearest[i] = -1;
+		if (rep[i] != i) { std::copy(octant_nn + 8 * rep[i], octant_nn + 8 * rep[i] + 8, octant_nn + 8 * i); }
+		auto min_md = Metric::distance(a.getX(), a.getY(), a.getX(), a.getY());
+		for (int k = 0; k < 8; ++k) {
+			const int j = octant_nn[8 * i + k];
+			if (j < 0) { continue; }
+			ref_type b = first[j];
+			const auto md = Metric::distance(a.getX(), a.getY(), b.getX(), b.getY());
+			if (nearest[i] < 0 || md < min_md) { nearest[i] = j; min_md = md; }
+		}
+	}
+
+	// a duplicated point is the nearest point of its group
+	if (duplicated) {
+		std::vector<int> twin(size, -1);
+		for (int i = 0; i < size; ++i) {
+			if (rep[i] != i) { nearest[i] = rep[i]; twin[rep[i]] = i; }
+		}
+		for (auto iter = unique.begin(); iter != unique.end(); ++iter) {
+			if (twin[*iter] >= 0) { nearest[*iter] = twin[*iter]; }
+		}
 	}
 }
 
@@ -0,0 +1,335 @@
+/*
+ * ----- Rectilinear Steiner Minimal Tree (RSMT) Heuristic -----
+ * Given a set of point, this file gives a function which improves the
+ * rectilinear minimum spanning tree into a rectilinear Steiner tree by
+ * edge substitution. Candidate point-edge connections are taken from the
+ * rectilinear spanning graph, so the whole flow is O(n log n).
+ *
+ *     ************************************************************************
+ *     * Copyright (C) 2015 lionking, National Chiao Tung University, Taiwan. *
+ *     * Permission to use, copy, modify, and distribute this                 *
+ *     * software and its documentation for any purpose and without           *
+ *     * fee is hereby granted, provided that the above copyright             *
+ *     * notice appear in all copies.                                         *
+ *     ************************************************************************
+ *
+ */
+
+#ifndef RSMT_HPP
+#define RSMT_HPP
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include "mst.hpp"
+#include "rsgc.hpp"
+
+
+/** steiner point created by findRSMT **/
+template <typename T>
+struct STEINER_POINT
+{
+	T x, y;
+	typedef T value_type;
+
+	STEINER_POINT(T a = T(), T b = T()) : x(a), y(b) {}
+	inline T getX() const { return x; }
+	inline T getY() const { return y; }
+};
+
+
+/******************* path query on a rooted spanning tree *******************
+* Binary lifting table which answers the longest edge on the tree path		*
+* between two nodes in O(log n).											*
+* An edge is identified by its child node: edge v is (v, parent[v]).		*
+****************************************************************************/
+template <typename T>
+class TreePathMax
+{
+private:
+	int size, level;
+	std::vector<int> depth;
+	std::vector<int> up;		// up[k*size + v]: 2^k-th ancestor of v
+	std::vector<T> max_w;		// max_w[k*size + v]: longest edge weight among those 2^k edges
+	std::vector<int> max_e;		// max_e[k*size + v]: the edge that max_w refers to
+
+	// merge the longest edge of (w, e) into (best_w, best_e)
+	inline void pick(const T w, const int e, T& best_w, int& best_e) const
+	{
+		if (best_e < 0 || best_w < w) { best_w = w; best_e = e; }
+	}
+
+public:
+	// parameter:
+	// 1. parent: parent[v] is the parent node of v (-1 for root)
+	// 2. weight: weight[v] is the weight of edge (v, parent[v])
+	// 3. order: nodes sorted in BFS order from root
+	TreePathMax(const std::vector<int>& parent, const std::vector<T>& weight, const std::vector<int>& order)
+		: size(static_cast<int>(parent.size())), level(1)
+	{
+		while ((1 << level) < size) { ++level; }
+		depth.assign(size, 0);
+		up.assign(level * size, -1);
+		max_w.assign(level * size, T());
+		max_e.assign(level * size, -1);
+
+		for (auto iter = order.begin(); iter != order.end(); ++iter) {
+			const int v = *iter;
+			if (parent[v] < 0) { continue; }
+			depth[v] = depth[parent[v]] + 1;
+			up[v] = parent[v];
+			max_w[v] = weight[v];
+			max_e[v] = v;
+		}
+		for (int k = 1; k < level; ++k) {
+			for (int v = 0; v < size; ++v) {
+				const int mid = up[(k - 1)*size + v];
+				if (mid < 0) { continue; }
+				up[k*size + v] = up[(k - 1)*size + mid];
+				max_w[k*size + v] = max_w[(k - 1)*size + v];
+				max_e[k*size + v] = max_e[(k - 1)*size + v];
+				if (max_e[(k - 1)*size + mid] >= 0) {
+					pick(max_w[(k - 1)*size + mid], max_e[(k - 1)*size + mid], max_w[k*size + v], max_e[k*size + v]);
+				}
+			}
+		}
+	}
+
+	// return the ancestor of v which has the given depth
+	int ancestor(int v, const int d) const
+	{
+		for (int k = level - 1; k >= 0 && v >= 0; --k) {
+			if (depth[v] - (1 << k) >= d) { v = up[k*size + v]; }
+		}
+		return v;
+	}
+
+	// check if u is inside the sub-tree rooted at v
+	inline bool inSubtree(const int u, const int v) const
+	{
+		return (depth[u] >= depth[v]) && (ancestor(u, depth[v]) == v);
+	}
+
+	// find the longest edge on the path between u and v
+	// return value: the longest edge (-1 when u == v), its weight is stored in w
+	int query(int u, int v, T& w) const
+	{
+		int best_e = -1;
+		w = T();
+		if (depth[u] < depth[v]) { std::swap(u, v); }
+		for (int k = level - 1; k >= 0; --k) {
+			if (depth[u] - (1 << k) >= depth[v]) {
+				pick(max_w[k*size + u], max_e[k*size + u], w, best_e);
+				u = up[k*size + u];
+			}
+		}
+		if (u == v) { return best_e; }
+		for (int k = level - 1; k >= 0; --k) {
+			if (up[k*size + u] != up[k*size + v]) {
+				pick(max_w[k*size + u], max_e[k*size + u], w, best_e);
+				pick(max_w[k*size + v], max_e[k*size + v], w, best_e);
+				u = up[k*size + u];
+				v = up[k*size + v];
+			}
+		}
+		pick(max_w[u], max_e[u], w, best_e);
+		pick(max_w[v], max_e[v], w, best_e);
+		return best_e;
+	}
+};
+
+
+/** candidate of connecting a point to a tree edge via a steiner point **/
+template <typename T>
+struct RSMT_CANDIDATE
+{
+	T gain;			// wirelength reduction
+	int point;		// point to be connected
+	int edge;		// tree edge to be connected (identified by its child node)
+	int remove;		// tree edge to be removed (identified by its child node)
+	T sx, sy;		// location of the steiner point
+};
+
+
+template <typename T>
+inline T median3(const T a, const T b, const T c)
+{
+	return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+
+/********************* build rectilinear Steiner tree (RSMT) *********************
+ * Reference:																	*
+ * Hai Zhou,																	*
+ * "Efficient Steiner Tree Construction Based on Spanning Graphs",				*
+ * ISPD, 2003																	*
+ * usage: r.f. to main															*
+ * parameter:																	*
+ * 1. first, last: range of points												*
+ * 2. steiner_set: steiner points used by the tree								*
+ * 3. tree_edge: edges of the tree. An endpoint i < n is the i-th point,		*
+ *    otherwise it is the (i - n)-th point of steiner_set						*
+ * return value: total wirelength of the tree									*
+ *********************************************************************************/
+template <typename RandomAccessIterator, typename T>
+T findRSMT(RandomAccessIterator first, RandomAccessIterator last, std::vector< STEINER_POINT<T> >& steiner_set, std::vector< EDGE<T> >& tree_edge)
+{
+	typedef typename std::iterator_traits<RandomAccessIterator>::reference			ref_type;
+	typedef typename std::iterator_traits<RandomAccessIterator>::difference_type	diff_type;
+	const diff_type size = last - first;
+
+	steiner_set.clear();
+	tree_edge.clear();
+	if (size < 2) { return T(); }
+
+	// start from the MST of the spanning graph
+	std::vector< EDGE<T> > rsg;
+	buildRSG(first, last, rsg);
+	bool* mst_edge = new bool[rsg.size()];
+	T wirelength = findMST(rsg.begin(), rsg.end(), mst_edge);
+	std::vector< EDGE<T> > mst;
+	mst.reserve(size - 1);
+	for (size_t i = 0; i < rsg.size(); ++i) {
+		if (mst_edge[i]) { mst.push_back(rsg[i]); }
+	}
+	delete[] mst_edge;
+	if (size < 3) { tree_edge.swap(mst); return wirelength; }
+
+	// adjacency lists of the MST and the spanning graph
+	std::vector< std::vector<int> > mst_adj(size), rsg_adj(size);
+	for (auto iter = mst.begin(); iter != mst.end(); ++iter) {
+		mst_adj[iter->p1].push_back(iter->p2);
+		mst_adj[iter->p2].push_back(iter->p1);
+	}
+	for (auto iter = rsg.begin(); iter != rsg.end(); ++iter) {
+		rsg_adj[iter->p1].push_back(iter->p2);
+		rsg_adj[iter->p2].push_back(iter->p1);
+	}
+
+	// root the MST at point 0
+	std::vector<int> parent(size, -1), order;
+	std::vector<T> parent_w(size, T());
+	order.reserve(size);
+	order.push_back(0);
+	for (size_t i = 0; i < order.size(); ++i) {
+		const int u = order[i];
+		for (auto iter = mst_adj[u].begin(); iter != mst_adj[u].end(); ++iter) {
+			if (*iter == parent[u]) { continue; }
+			parent[*iter] = u;
+			ref_type a = first[u];
+			ref_type b = first[*iter];
+			parent_w[*iter] = computeMD<T>(a.getX(), a.getY(), b.getX(), b.getY());
+			order.push_back(*iter);
+		}
+	}
+	TreePathMax<T> path(parent, parent_w, order);
+
+	// for each point p, try to connect p to the MST edges adjacent to its neighbors in the spanning graph
+	std::vector< RSMT_CANDIDATE<T> > candidate;
+	for (int p = 0; p < size; ++p) {
+		ref_type pp = first[p];
+		for (auto nb = rsg_adj[p].begin(); nb != rsg_adj[p].end(); ++nb) {
+			for (auto tn = mst_adj[*nb].begin(); tn != mst_adj[*nb].end(); ++tn) {
+				if (*tn == p) { continue; }
+				const int a = *nb, b = *tn;
+				ref_type pa = first[a];
+				ref_type pb = first[b];
+				RSMT_CANDIDATE<T> cand;
+				cand.sx = median3<T>(pp.getX(), pa.getX(), pb.getX());
+				cand.sy = median3<T>(pp.getY(), pa.getY(), pb.getY());
+				// the steiner point is degenerated to an existing point
+				if ((cand.sx == pa.getX() && cand.sy == pa.getY()) || (cand.sx == pb.getX() && cand.sy == pb.getY())) { continue; }
+
+				// the longest edge on the cycle formed by (p, steiner point)
+				const int child = (parent[a] == b) ? a : b;
+				const int end = path.inSubtree(p, child) ? child : parent[child];
+				T remove_w = T();
+				cand.remove = path.query(p, end, remove_w);
+				if (cand.remove < 0) { continue; }
+
+				cand.gain = remove_w - computeMD<T>(pp.getX(), pp.getY(), cand.sx, cand.sy);
+				if (cand.gain <= T()) { continue; }
+				cand.point = p;
+				cand.edge = child;
+				candidate.push_back(cand);
+			}
+		}
+	}
+	if (candidate.empty()) { tree_edge.swap(mst); return wirelength; }
+
+	// apply non-conflicting substitutions with the largest gain first
+	std::sort(candidate.begin(), candidate.end(),
+		[](const RSMT_CANDIDATE<T>& lhs, const RSMT_CANDIDATE<T>& rhs) -> bool { return lhs.gain > rhs.gain; });
+	std::vector<bool> touched(size, false);
+	std::vector< EDGE<T> > graph(mst);
+	for (auto iter = candidate.begin(); iter != candidate.end(); ++iter) {
+		if (touched[iter->edge] || touched[iter->remove]) { continue; }
+		touched[iter->edge] = touched[iter->remove] = true;
+
+		const int s = size + static_cast<int>(steiner_set.size());
+		const int a = iter->edge, b = parent[iter->edge];
+		ref_type pa = first[a];
+		ref_type pb = first[b];
+		ref_type pp = first[iter->point];
+		steiner_set.emplace_back(iter->sx, iter->sy);
+		graph.emplace_back(a, s, computeMD<T>(pa.getX(), pa.getY(), iter->sx, iter->sy));
+		graph.emplace_back(b, s, computeMD<T>(pb.getX(), pb.getY(), iter->sx, iter->sy));
+		graph.emplace_back(iter->point, s, computeMD<T>(pp.getX(), pp.getY(), iter->sx, iter->sy));
+	}
+
+	// substitutions are evaluated on the original MST, hence re-connect the
+	// result by Kruskal which never gets longer than the substituted tree
+	const int node_count = size + static_cast<int>(steiner_set.size());
+	std::sort(graph.begin(), graph.end(), [](const EDGE<T>& lhs, const EDGE<T>& rhs) -> bool { return lhs.weight < rhs.weight; });
+	DisjointSet ds(node_count);
+	std::vector< std::vector<int> > tree_adj(node_count);
+	for (auto iter = graph.begin(); iter != graph.end(); ++iter) {
+		if (ds.checkRoot(iter->p1) != ds.checkRoot(iter->p2)) {
+			ds.unionSet(iter->p1, iter->p2);
+			tree_adj[iter->p1].push_back(iter->p2);
+			tree_adj[iter->p2].push_back(iter->p1);
+		}
+	}
+
+	// remove steiner points of degree 1, and bypass those of degree 2
+	// note: steiner points are only adjacent to given points
+	std::vector<STEINER_POINT<T> > steiner_used;
+	std::vector<int> steiner_id(steiner_set.size(), -1);
+	for (int s = size; s < node_count; ++s) {
+		std::vector<int>& adj = tree_adj[s];
+		if (adj.size() == 2) {
+			std::replace(tree_adj[adj[0]].begin(), tree_adj[adj[0]].end(), s, adj[1]);
+			std::replace(tree_adj[adj[1]].begin(), tree_adj[adj[1]].end(), s, adj[0]);
+		}
+		else if (adj.size() == 1) {
+			tree_adj[adj[0]].erase(std::find(tree_adj[adj[0]].begin(), tree_adj[adj[0]].end(), s));
+		}
+		else {
+			steiner_id[s - size] = size + static_cast<int>(steiner_used.size());
+			steiner_used.push_back(steiner_set[s - size]);
+		}
+	}
+	steiner_set.swap(steiner_used);
+
+	wirelength = T();
+	for (int u = 0; u < node_count; ++u) {
+		if (u >= size && steiner_id[u - size] < 0) { continue; }
+		const int nu = (u < size) ? u : steiner_id[u - size];
+		const T ux = (u < size) ? static_cast<T>(first[u].getX()) : steiner_set[nu - size].x;
+		const T uy = (u < size) ? static_cast<T>(first[u].getY()) : steiner_set[nu - size].y;
+		for (auto iter = tree_adj[u].begin(); iter != tree_adj[u].end(); ++iter) {
+			if (*iter < u) { continue; }
+			const int nv = (*iter < size) ? *iter : steiner_id[*iter - size];
+			const T vx = (*iter < size) ? static_cast<T>(first[*iter].getX()) : steiner_set[nv - size].x;
+			const T vy = (*iter < size) ? static_cast<T>(first[*iter].getY()) : steiner_set[nv - size].y;
+			const T w = computeMD(ux, uy, vx, vy);
+			tree_edge.emplace_back(nu, nv, w);
+			wirelength += w;
+		}
+	}
+
+	return wirelength;
+}
+
+
+#endif